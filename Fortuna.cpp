@@ -3,11 +3,31 @@
 #include <fstream>                   // For reading/writing seed file
 #include <vector>                    // For dynamic arrays
 #include <array>                     // For fixed-size entropy pool array
+#include <memory_resource>           // For std::pmr allocator-aware buffers
 #include <cstdint>                   // For fixed-size integer types
 #include <cstring>                   // For memory operations
+#include <utility>                   // For std::move
+#include <memory>                    // For shared seed store ownership
+#include <string>                    // For file paths and slot names
+#include <map>                       // For the tenant registry
+#include <mutex>                     // For per-tenant locks
+#include <shared_mutex>              // For the tenant map lock
+#include <chrono>                    // For timing (conditioner metrics, benchmarks)
+#include <stdexcept>                 // For std::runtime_error
+#include <algorithm>                 // For std::min
+#include <cmath>                     // For sampler math (log, sqrt, lgamma)
+#include <cerrno>                    // For errno (slot owner liveness check)
+#include <fcntl.h>                   // For open(), posix_fallocate()
+#include <signal.h>                  // For kill() (slot owner liveness check)
+#include <sys/mman.h>                // For mmap()
+#include <sys/stat.h>                // For fstat()
+#include <unistd.h>                  // For pread(), getpid()
 #include <openssl/evp.h>            // For AES encryption
 #include <openssl/rand.h>           // For secure random bytes
 #include <openssl/sha.h>            // For SHA-256 hash
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>               // For PCLMULQDQ carry-less multiply
+#endif
 
 // Helper: SHA-256 hash function
 std::vector<uint8_t> sha256(const std::vector<uint8_t>& data) {
@@ -16,18 +36,6 @@ std::vector<uint8_t> sha256(const std::vector<uint8_t>& data) {
     return hash;                                                     // Return hash as byte vector
 }
 
-// Helper: AES-256-CTR encryption of a 16-byte counter block using a 32-byte key
-std::vector<uint8_t> encryptCounter(const std::vector<uint8_t>& key, const std::vector<uint8_t>& counterBlock) {
-    std::vector<uint8_t> out(counterBlock.size());                  // Output buffer same size as input block
-    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();                     // Create new encryption context
-    EVP_EncryptInit_ex(ctx, EVP_aes_256_ctr(), nullptr, key.data(), nullptr); // Initialize AES-CTR with key, default IV (null)
-    int outlen;                                                     // Length of output buffer
-    EVP_EncryptUpdate(ctx, out.data(), &outlen, counterBlock.data(), counterBlock.size()); // Encrypt the counter block
-    EVP_EncryptFinal_ex(ctx, out.data() + outlen, &outlen);         // Finalize encryption (not really needed in CTR mode)
-    EVP_CIPHER_CTX_free(ctx);                                       // Clean up
-    return out;                                                     // Return encrypted block
-}
-
 // Class: EntropyAccumulator - collects entropy into multiple pools (32 total)
 class EntropyAccumulator {
     static const int POOL_COUNT = 32;                               // Total number of entropy pools
@@ -51,6 +59,23 @@ public:
         return seed;                                                // Return new seed
     }
 
+    // Same as getReseedEntropy(), but all buffers (scratch and result) come from resource
+    std::pmr::vector<uint8_t> getReseedEntropy(std::pmr::memory_resource* resource) {
+        size_t total = 0;                                           // Total bytes across pools
+        for (const auto& pool : pools) {
+            total += pool.size();                                   // Sum pool sizes
+        }
+        std::pmr::vector<uint8_t> combined(resource);               // Combined data from all pools
+        combined.reserve(total);                                    // Single allocation from resource
+        for (const auto& pool : pools) {
+            combined.insert(combined.end(), pool.begin(), pool.end()); // Append each pool to combined data
+        }
+        std::pmr::vector<uint8_t> seed(SHA256_DIGEST_LENGTH, resource); // Output buffer for 32-byte hash
+        SHA256(combined.data(), combined.size(), seed.data());      // Hash the combined data
+        clearPools();                                               // Clear pools after reseed
+        return seed;                                                // Return new seed
+    }
+
     // Clear all entropy pools
     void clearPools() {
         for (auto& pool : pools) {
@@ -59,28 +84,454 @@ public:
     }
 };
 
-// Class: SeedManager - responsible for loading/saving seed to local file
+// Class: ToeplitzExtractor - compresses low-density raw noise with a random Toeplitz matrix
+//
+// Output bit i of a block is the GF(2) inner product of the input with row i of
+// a Toeplitz matrix built from a random seed. That product is a slice of the
+// carry-less product seed(x) * input(x), so each block costs a few 64x64
+// carry-less multiplies per output word (PCLMULQDQ when the CPU has it).
+class ToeplitzExtractor {
+    size_t inWords;                                                 // Input block size in 64-bit words
+    size_t outWords;                                                // Output block size in 64-bit words
+    std::vector<uint64_t> reversed;                                 // Seed words in reverse order (see seedFor)
+    bool useClmul;                                                  // Hardware carry-less multiply available
+    mutable std::vector<uint64_t> words;                            // Word-aligned input copy (scalar path)
+
+    // Seed words for output word w: result[j] = seed[w - j], so the pair
+    // (seed[w - j], seed[w - j - 1]) is one contiguous 16-byte load
+    const uint64_t* seedFor(size_t w) const {
+        return reversed.data() + (reversed.size() - 1 - w);
+    }
+
+    // Portable 64x64 -> 128-bit carry-less multiply
+    static void clmulScalar(uint64_t a, uint64_t b, uint64_t& lo, uint64_t& hi) {
+        lo = 0;
+        hi = 0;
+        for (int bit = 0; bit < 64; ++bit) {
+            if ((b >> bit) & 1) {
+                lo ^= a << bit;                                     // Low half of shifted a
+                hi ^= bit ? a >> (64 - bit) : 0;                    // Bits shifted out of the low half
+            }
+        }
+    }
+
+    // One output word (and its carry) using the portable multiply
+    void accumulateScalar(const uint64_t* in, size_t w, uint64_t& lo, uint64_t& hi) const {
+        const uint64_t* s = seedFor(w);
+        lo = 0;
+        hi = 0;
+        for (size_t j = 0; j < inWords; ++j) {
+            uint64_t l, h;
+            clmulScalar(s[j], in[j], l, h);                         // seed word * input word
+            lo ^= l;
+            hi ^= h;
+        }
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    // One output word (and its carry) using PCLMULQDQ, two products per 16-byte load pair
+    __attribute__((target("pclmul,sse2")))
+    void accumulateClmul(const uint8_t* in, size_t w, uint64_t& lo, uint64_t& hi) const {
+        const uint64_t* s = seedFor(w);
+        __m128i acc0 = _mm_setzero_si128();                         // Two independent accumulators
+        __m128i acc1 = _mm_setzero_si128();
+        size_t j = 0;
+        for (; j + 1 < inWords; j += 2) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + j * 8)); // in[j], in[j+1]
+            __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + j)); // seed[w-j], seed[w-j-1]
+            acc0 = _mm_xor_si128(acc0, _mm_clmulepi64_si128(k, x, 0x00)); // seed[w-j] * in[j]
+            acc1 = _mm_xor_si128(acc1, _mm_clmulepi64_si128(k, x, 0x11)); // seed[w-j-1] * in[j+1]
+        }
+        if (j < inWords) {                                          // Odd word count
+            __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + j * 8)); // 64-bit load, also on i386
+            __m128i k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(s + j));
+            acc0 = _mm_xor_si128(acc0, _mm_clmulepi64_si128(k, x, 0x00));
+        }
+        uint64_t out[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_xor_si128(acc0, acc1));
+        lo = out[0];
+        hi = out[1];
+    }
+#endif
+
+public:
+    // Constructor: compress ratio:1 into outputBytes per block (multiple of 8)
+    ToeplitzExtractor(size_t ratio = 8, size_t outputBytes = 32)
+        : inWords(outputBytes * ratio / 8), outWords(outputBytes / 8), reversed(inWords + outWords),
+          words(inWords) {
+        if (ratio == 0) {
+            throw std::invalid_argument("ToeplitzExtractor: compression ratio must be at least 1");
+        }
+        if (outputBytes == 0 || outputBytes % 8 != 0) {
+            throw std::invalid_argument("ToeplitzExtractor: output must be a non-zero multiple of 8 bytes");
+        }
+        RAND_bytes(reinterpret_cast<uint8_t*>(reversed.data()), reversed.size() * sizeof(uint64_t)); // Random matrix
+#if defined(__x86_64__) || defined(__i386__)
+        useClmul = __builtin_cpu_supports("pclmul");                // Pick the kernel once
+#else
+        useClmul = false;
+#endif
+    }
+
+    size_t inputBlockSize() const { return inWords * 8; }            // Raw bytes consumed per block
+    size_t outputBlockSize() const { return outWords * 8; }          // Conditioned bytes produced per block
+
+    // Compress one input block (inputBlockSize() bytes) into out (outputBlockSize() bytes)
+    void extract(const uint8_t* in, uint8_t* out) const {
+        if (!useClmul) std::memcpy(words.data(), in, inWords * 8);  // Aligned copy for the scalar path
+        // Output word k is word inWords + k of seed * input: its low half from the
+        // products landing on that word, its high half carried from the word below
+        uint64_t carry = 0;                                         // High half of the previous word
+        for (size_t w = inWords - 1; w < inWords + outWords; ++w) {
+            uint64_t lo, hi;
+#if defined(__x86_64__) || defined(__i386__)
+            if (useClmul) accumulateClmul(in, w, lo, hi);
+            else accumulateScalar(words.data(), w, lo, hi);
+#else
+            accumulateScalar(words.data(), w, lo, hi);
+#endif
+            if (w >= inWords) {
+                uint64_t value = lo ^ carry;                        // Product word w
+                std::memcpy(out + (w - inWords) * 8, &value, 8);
+            }
+            carry = hi;
+        }
+    }
+};
+
+// Class: EntropyConditioner - optional extraction stage in front of the entropy pools
+//
+// Raw bytes from high-volume, low-density sources are buffered per source and
+// compressed block by block with a ToeplitzExtractor; only the extracted output
+// reaches EntropyAccumulator::addEntropy. Per-source metrics track volume,
+// compression ratio and the stage's throughput.
+class EntropyConditioner {
+public:
+    // Per-source metrics
+    struct Stats {
+        uint64_t bytesIn = 0;                                       // Raw bytes received
+        uint64_t bytesOut = 0;                                      // Conditioned bytes sent to the pools
+        double seconds = 0;                                         // Time spent in addRaw (extraction and pool ingestion)
+
+        double compressionRatio() const { return bytesOut ? double(bytesIn) / bytesOut : 0; }
+        double throughputMBs() const { return seconds > 0 ? bytesIn / seconds / 1e6 : 0; }
+    };
+
+private:
+    struct Source {
+        std::vector<uint8_t> pending;                               // Raw bytes waiting for a full block
+        Stats stats;                                                // Metrics for this source
+    };
+
+    EntropyAccumulator& accumulator;                                // Pools fed by this stage
+    ToeplitzExtractor extractor;                                    // Shared extraction matrix
+    std::map<int, Source> sources;                                  // State per source ID
+    std::vector<uint8_t> out;                                       // One conditioned block (reused)
+
+public:
+    // Constructor: feed accumulator, compressing ratio:1 into outputBytes per block
+    EntropyConditioner(EntropyAccumulator& target, size_t ratio = 8, size_t outputBytes = 32)
+        : accumulator(target), extractor(ratio, outputBytes), out(extractor.outputBlockSize()) {}
+
+    // Add raw noise from a source; full blocks are extracted and forwarded immediately
+    void addRaw(const uint8_t* data, size_t size, int source = 0) {
+        auto begin = std::chrono::steady_clock::now();              // Time the whole stage
+        Source& state = sources[source];
+        state.stats.bytesIn += size;
+        const size_t blockIn = extractor.inputBlockSize();
+
+        if (!state.pending.empty()) {                               // Complete a partial block first
+            size_t take = std::min(blockIn - state.pending.size(), size);
+            state.pending.insert(state.pending.end(), data, data + take);
+            data += take;
+            size -= take;
+            if (state.pending.size() == blockIn) {
+                extractor.extract(state.pending.data(), out.data());
+                accumulator.addEntropy(out, source);
+                state.stats.bytesOut += out.size();
+                state.pending.clear();
+            }
+        }
+        for (; size >= blockIn; data += blockIn, size -= blockIn) { // Whole blocks straight from input
+            extractor.extract(data, out.data());
+            accumulator.addEntropy(out, source);
+            state.stats.bytesOut += out.size();
+        }
+        state.pending.insert(state.pending.end(), data, data + size); // Keep the remainder
+
+        auto end = std::chrono::steady_clock::now();
+        state.stats.seconds += std::chrono::duration<double>(end - begin).count();
+    }
+
+    // Convenience overload for vector input
+    void addRaw(const std::vector<uint8_t>& data, int source = 0) {
+        addRaw(data.data(), data.size(), source);
+    }
+
+    // Metrics for one source (zeros if it has not been seen)
+    Stats stats(int source) const {
+        auto it = sources.find(source);
+        return it == sources.end() ? Stats() : it->second.stats;
+    }
+};
+
+// Error: the seed file cannot be used here (open, size or map failed, e.g. permissions)
+class SeedStoreUnavailable : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Error: the seed file exists but is not a valid seed store (wrong format, truncated)
+class SeedStoreCorrupt : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Class: SeedStore - per-instance seed slots in one shared, memory-mapped file
+//
+// Many processes can share the same file. Each instance claims its own slot, so
+// no two instances start from the same seed. Updates are lock-free: every slot
+// holds two copies, each stamped with a generation number and a checksum. A
+// writer takes a fresh generation, fills the copy it selects and publishes the
+// generation last; readers take the newest copy whose checksum verifies, so a
+// torn or half-written copy is simply skipped.
+class SeedStore {
+public:
+    static constexpr size_t SEED_SIZE = 32;                         // Seed length in bytes
+    static constexpr size_t DEFAULT_SLOTS = 64;                     // Slots in a newly created file
+    static constexpr size_t NO_SLOT = static_cast<size_t>(-1);      // Returned when every slot is taken
+    static constexpr size_t MAX_SLOTS = 1 << 16;                    // Upper bound accepted from a file header
+
+private:
+    static constexpr uint64_t MAGIC = 0x3130534e54524f46ULL;        // "FORTNS01" in little-endian
+
+    struct SeedCopy {
+        uint64_t generation;                                        // 0 = empty or being written
+        uint8_t seed[SEED_SIZE];                                    // Seed bytes
+        uint64_t checksum;                                          // Truncated SHA-256(generation || seed)
+    };
+
+    struct Slot {
+        uint64_t owner;                                             // 0 = free, otherwise owner tag
+        uint64_t generation;                                        // Last generation handed to a writer
+        SeedCopy copies[2];                                         // Double buffer, selected by generation
+    };
+
+    struct Header {
+        uint64_t magic;                                             // File format marker
+        uint64_t slotCount;                                         // Number of slots following the header
+    };
+
+    Header* header = nullptr;                                       // Start of the mapping
+    Slot* slots = nullptr;                                          // Slot array inside the mapping
+    size_t slotCount = 0;                                           // Number of slots
+    size_t mappedSize = 0;                                          // Bytes mapped
+
+    // Checksum binding a copy's generation to its seed bytes
+    static uint64_t checksum(uint64_t generation, const uint8_t* seed) {
+        uint8_t data[sizeof(generation) + SEED_SIZE];               // generation || seed
+        std::memcpy(data, &generation, sizeof(generation));
+        std::memcpy(data + sizeof(generation), seed, SEED_SIZE);
+        uint8_t hash[SHA256_DIGEST_LENGTH];                         // Full digest
+        SHA256(data, sizeof(data), hash);                           // Hash generation and seed together
+        uint64_t sum;
+        std::memcpy(&sum, hash, sizeof(sum));                       // Keep the first 8 bytes
+        return sum;
+    }
+
+    // True if the slot belongs to a process tag whose process no longer exists
+    static bool ownerIsDead(uint64_t owner) {
+        if (!(owner & PROCESS_TAG_BIT)) return false;               // Caller-chosen tags never expire
+        pid_t pid = static_cast<pid_t>((owner & ~PROCESS_TAG_BIT) >> 24); // Pid stored above the counter
+        return kill(pid, 0) == -1 && errno == ESRCH;                // No such process
+    }
+
+public:
+    static constexpr uint64_t PROCESS_TAG_BIT = 1ULL << 63;         // Marks tags owned by a live process
+
+    // Open (or create) the store at path and map it into memory
+    //
+    // Initialisation order: the first opener stores slotCount (CAS from 0), then
+    // publishes the magic. A zero slotCount means "not initialised yet"; a set
+    // slotCount wins over the requested one, and is checked against the file size.
+    explicit SeedStore(const std::string& path, size_t slots = DEFAULT_SLOTS) {
+        int fd = open(path.c_str(), O_RDWR | O_CREAT, 0600);        // Seed file is private to the user
+        if (fd < 0) throw SeedStoreUnavailable("SeedStore: cannot open " + path);
+        auto fail = [&](const std::string& what) {                  // Environment problem
+            close(fd);
+            throw SeedStoreUnavailable("SeedStore: " + path + ": " + what);
+        };
+        auto corrupt = [&](const std::string& what) {               // Bad file contents
+            close(fd);
+            throw SeedStoreCorrupt("SeedStore: " + path + ": " + what);
+        };
+        for (;;) {
+            Header existing = {};                                   // Existing header, if any
+            if (pread(fd, &existing, sizeof(existing), 0) == sizeof(existing)) {
+                if (existing.magic != 0 && existing.magic != MAGIC) corrupt("not a seed store");
+                if (existing.slotCount != 0) slots = existing.slotCount; // Initialised (or being initialised)
+            }
+            if (slots == 0 || slots > MAX_SLOTS) corrupt("bad slot count");
+            mappedSize = sizeof(Header) + slots * sizeof(Slot);     // Header followed by slots
+            struct stat st;
+            if (fstat(fd, &st) != 0) fail("cannot stat");
+            if (static_cast<size_t>(st.st_size) < mappedSize) {
+                if (existing.magic == MAGIC) corrupt("truncated");  // Initialised file smaller than its header says
+                if (posix_fallocate(fd, 0, mappedSize) != 0) fail("cannot size"); // Grows (zero-filled), never shrinks
+            }
+            void* map = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (map == MAP_FAILED) fail("cannot map");
+            header = static_cast<Header*>(map);
+
+            uint64_t expected = 0;                                  // First opener stores the slot count
+            if (!__atomic_compare_exchange_n(&header->slotCount, &expected, slots, false,
+                                             __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) &&
+                expected != slots) {                                // Another opener chose a different size
+                munmap(map, mappedSize);
+                header = nullptr;
+                slots = expected;
+                continue;                                           // Map again with its slot count
+            }
+            expected = 0;                                           // Then publishes the magic
+            if (!__atomic_compare_exchange_n(&header->magic, &expected, MAGIC, false,
+                                             __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) &&
+                expected != MAGIC) {
+                munmap(map, mappedSize);
+                header = nullptr;
+                corrupt("not a seed store");
+            }
+            break;
+        }
+        close(fd);                                                  // Mapping keeps the file alive
+        this->slots = reinterpret_cast<Slot*>(header + 1);          // Slots follow the header
+        slotCount = slots;
+    }
+
+    ~SeedStore() {
+        if (header) munmap(header, mappedSize);                     // Unmap the file
+    }
+
+    SeedStore(const SeedStore&) = delete;
+    SeedStore& operator=(const SeedStore&) = delete;
+
+    // Owner tag for a new instance in this process (pid plus a per-process counter)
+    static uint64_t processTag() {
+        static uint64_t counter = 0;                                // Instances created in this process
+        uint64_t n = __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED) & 0xFFFFFF;
+        return PROCESS_TAG_BIT | (static_cast<uint64_t>(getpid()) << 24) | n;
+    }
+
+    // Claim the slot owned by tag, else a free slot, else one left by a dead process
+    size_t claimSlot(uint64_t tag) {
+        for (size_t i = 0; i < slotCount; ++i) {                    // Already ours (caller-chosen tags)
+            if (__atomic_load_n(&slots[i].owner, __ATOMIC_ACQUIRE) == tag) return i;
+        }
+        for (size_t i = 0; i < slotCount; ++i) {                    // Free or abandoned slot
+            uint64_t owner = __atomic_load_n(&slots[i].owner, __ATOMIC_ACQUIRE);
+            if ((owner == 0 || ownerIsDead(owner)) &&
+                __atomic_compare_exchange_n(&slots[i].owner, &owner, tag, false,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                return i;                                           // Won the race for this slot
+            }
+        }
+        return NO_SLOT;                                             // Store is full
+    }
+
+    // Give a slot back (its last seed stays for the next owner)
+    void releaseSlot(size_t slot, uint64_t tag) {
+        uint64_t expected = tag;
+        __atomic_compare_exchange_n(&slots[slot].owner, &expected, 0, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    }
+
+    // Read the newest intact seed in a slot; returns false if the slot holds none
+    bool read(size_t slot, uint8_t* seed) const {
+        uint64_t best = 0;                                          // Newest valid generation seen
+        for (const SeedCopy& copy : slots[slot].copies) {
+            uint64_t before = __atomic_load_n(&copy.generation, __ATOMIC_ACQUIRE);
+            uint8_t candidate[SEED_SIZE];
+            std::memcpy(candidate, copy.seed, SEED_SIZE);           // Snapshot the seed
+            uint64_t sum = copy.checksum;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            uint64_t after = __atomic_load_n(&copy.generation, __ATOMIC_RELAXED);
+            if (before == 0 || before != after || before <= best) continue; // Empty, changing or older
+            if (sum != checksum(before, candidate)) continue;       // Torn write
+            std::memcpy(seed, candidate, SEED_SIZE);
+            best = before;
+        }
+        return best != 0;
+    }
+
+    // Publish a new seed in a slot without blocking other writers
+    void write(size_t slot, const uint8_t* seed) {
+        Slot& s = slots[slot];
+        uint64_t generation = __atomic_add_fetch(&s.generation, 1, __ATOMIC_ACQ_REL); // Unique per writer
+        SeedCopy& copy = s.copies[generation & 1];                  // Leaves the other copy intact
+        __atomic_store_n(&copy.generation, 0, __ATOMIC_RELAXED);    // Mark copy as being written
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        std::memcpy(copy.seed, seed, SEED_SIZE);                    // Fill the copy
+        copy.checksum = checksum(generation, seed);
+        __atomic_store_n(&copy.generation, generation, __ATOMIC_RELEASE); // Publish
+        msync(header, mappedSize, MS_ASYNC);                        // Schedule write-back to disk
+    }
+};
+
+// Class: SeedManager - responsible for loading/saving this instance's seed slot
 class SeedManager {
-    const std::string path = "seed.dat";                            // File path for storing seed
+    std::shared_ptr<SeedStore> store;                               // Shared seed file
+    uint64_t tag;                                                   // Owner tag for our slot
+    size_t slot;                                                    // Claimed slot (or NO_SLOT)
 
 public:
-    // Load seed from file or create a new one if file doesn't exist
+    // Claim a per-process slot in the default seed file
+    SeedManager() : SeedManager(openStore("seeds.dat"), SeedStore::processTag()) {}
+
+    // Claim the slot for tag in a given store (no store: in-memory random seed only)
+    SeedManager(std::shared_ptr<SeedStore> seedStore, uint64_t ownerTag)
+        : store(std::move(seedStore)), tag(ownerTag),
+          slot(store ? store->claimSlot(ownerTag) : SeedStore::NO_SLOT) {}
+
+    // Open the store at path, or return null if it cannot be used here (e.g. a read-only
+    // directory); the instance then runs without persistence. A corrupt store is not
+    // hidden: SeedStoreCorrupt propagates to the caller.
+    static std::shared_ptr<SeedStore> openStore(const std::string& path) {
+        try {
+            return std::make_shared<SeedStore>(path);
+        } catch (const SeedStoreUnavailable&) {
+            return nullptr;
+        }
+    }
+
+    ~SeedManager() {
+        if (slot != SeedStore::NO_SLOT && (tag & SeedStore::PROCESS_TAG_BIT)) {
+            store->releaseSlot(slot, tag);                          // Let a later process inherit it
+        }
+    }
+
+    SeedManager(const SeedManager&) = delete;
+    SeedManager& operator=(const SeedManager&) = delete;
+
+    // Load seed from our slot and return a key derived from it. The slot is rotated to
+    // SHA-256(old seed || fresh random bytes) before the key is handed out, so a later
+    // owner of the slot never starts from the same key.
     std::vector<uint8_t> loadSeed() {
-        std::ifstream in(path, std::ios::binary);                   // Open file for binary reading
-        if (in) {
-            return std::vector<uint8_t>((std::istreambuf_iterator<char>(in)), {}); // Read contents to vector
-        } else {
-            std::vector<uint8_t> seed(32);                          // Create empty buffer for 32-byte seed
-            RAND_bytes(seed.data(), 32);                            // Fill buffer with random bytes
-            saveSeed(seed);                                         // Save seed to file
-            return seed;                                            // Return newly created seed
+        const size_t n = SeedStore::SEED_SIZE;
+        uint8_t input[2 * n];                                       // old seed || fresh randomness
+        if (slot == SeedStore::NO_SLOT || !store->read(slot, input)) {
+            RAND_bytes(input, n);                                   // Empty slot: start from random bytes
         }
+        RAND_bytes(input + n, n);                                   // Fresh randomness for this run
+        std::vector<uint8_t> seed(n);                               // Rotated seed
+        SHA256(input, sizeof(input), seed.data());
+        saveSeed(seed);                                             // Replace the stored seed before use
+        seed.push_back(0x01);                                       // Domain separator for the key
+        return sha256(seed);                                        // Key derived from, not equal to, the seed
     }
 
-    // Save seed to file
+    // Save seed to our slot
     void saveSeed(const std::vector<uint8_t>& seed) {
-        std::ofstream out(path, std::ios::binary);                  // Open file for binary writing
-        out.write(reinterpret_cast<const char*>(seed.data()), seed.size()); // Write seed to file
+        if (slot == SeedStore::NO_SLOT || seed.size() != SeedStore::SEED_SIZE) return; // Nothing to persist into
+        store->write(slot, seed.data());                            // Publish seed
     }
 };
 
@@ -90,21 +541,27 @@ class Generator {
     uint64_t counter = 0;                                           // Counter for AES-CTR mode
     const size_t dataLimit = 1024 * 1024;                           // Limit before rekeying (1 MiB)
     size_t dataGenerated = 0;                                       // Total data generated since last rekey
+    EVP_CIPHER_CTX* ctx;                                            // AES-256-CTR context, keyed with key
 
 public:
     // Constructor: generate random key
-    Generator() {
+    Generator() : ctx(EVP_CIPHER_CTX_new()) {
         key.resize(32);                                             // Allocate 32 bytes for key
         RAND_bytes(key.data(), 32);                                 // Fill key with secure random bytes
+        applyKey();                                                 // Run the key schedule once
+    }
+
+    ~Generator() {
+        EVP_CIPHER_CTX_free(ctx);                                   // Clean up
     }
 
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
     // Generate a 16-byte random block using AES-CTR
     std::vector<uint8_t> generateBlock() {
-        std::vector<uint8_t> counterBlock(16, 0);                   // AES block initialized to zero
-        uint64_t* counterPtr = reinterpret_cast<uint64_t*>(&counterBlock[8]); // Pointer to second half of block
-        *counterPtr = htobe64(counter);                             // Set counter (big-endian)
-        
-        auto block = encryptCounter(key, counterBlock);             // Encrypt counter block
+        std::vector<uint8_t> block(16);                             // Output block
+        encryptRun(block.data(), block.size());                     // Encrypt counter block
         counter++;                                                  // Increment counter for next block
         dataGenerated += block.size();                              // Track data generated
 
@@ -115,15 +572,101 @@ public:
         return block;                                               // Return generated block
     }
 
+    // Generate Blocks consecutive 16-byte blocks straight into out (fixed-size fast path)
+    template <size_t Blocks>
+    void generateBlocks(uint8_t* out) {
+        if (dataGenerated + Blocks * 16 > dataLimit) {              // Rare: rekey would land mid-batch
+            generate(out, Blocks);                                  // Split the batch at the rekey point
+            return;
+        }
+        encryptRun(out, Blocks * 16);                               // Whole batch in one cipher call
+        counter += Blocks;                                          // Advance counter past the batch
+        dataGenerated += Blocks * 16;                               // Track data generated
+        if (dataGenerated >= dataLimit) {                           // If limit reached exactly, rekey
+            rekey();                                                // Rekey using SHA-256 of current key
+        }
+    }
+
+    // Generate any number of 16-byte blocks straight into out, rekeying exactly where
+    // repeated generateBlock() calls would
+    void generate(uint8_t* out, size_t blocks) {
+        while (blocks > 0) {
+            size_t run = std::min(blocks, (dataLimit - dataGenerated) / 16); // Blocks left before the rekey limit
+            encryptRun(out, run * 16);                              // One cipher call for the run
+            counter += run;                                         // Advance counter past the run
+            dataGenerated += run * 16;                              // Track data generated
+            if (dataGenerated >= dataLimit) {                       // If limit reached, rekey
+                rekey();                                            // Rekey using SHA-256 of current key
+            }
+            out += run * 16;
+            blocks -= run;
+        }
+    }
+
     // Rekey: derive new key by hashing current key
     void rekey() {
         key = sha256(key);                                          // Replace key with SHA-256 hash of current key
+        applyKey();                                                 // Re-key the cipher context
         dataGenerated = 0;                                          // Reset data counter
     }
 
     // Set generator key manually (for seeding)
     void setKey(const std::vector<uint8_t>& newKey) {
         key = newKey;                                               // Set internal key to given value
+        applyKey();                                                 // Re-key the cipher context
+    }
+
+    // Reseed: new key = SHA-256(current key || seed), so fixed entropy never resets the key
+    void reseed(const std::vector<uint8_t>& seed) {
+        std::vector<uint8_t> input(key);                            // Current key
+        input.insert(input.end(), seed.begin(), seed.end());        // Followed by the new seed
+        setKey(sha256(input));                                      // Hash into the new key
+    }
+
+    // Known-answer check: keystream blocks must equal AES-256-ECB(key, counter block)
+    static bool knownAnswerTest() {
+        std::vector<uint8_t> testKey(32);                           // Fixed test key 00 01 .. 1f
+        for (size_t i = 0; i < testKey.size(); ++i) testKey[i] = static_cast<uint8_t>(i);
+        Generator generator;
+        generator.setKey(testKey);
+        uint8_t stream[64];                                         // Blocks 0..3 from the generator
+        auto first = generator.generateBlock();                     // Block 0 via the single-block path
+        std::memcpy(stream, first.data(), 16);
+        generator.generateBlocks<3>(stream + 16);                   // Blocks 1..3 via the batched path
+
+        uint8_t counters[64] = {};                                  // Counter blocks 0..3
+        for (uint64_t i = 0; i < 4; ++i) writeCounter(counters + i * 16 + 8, i);
+        uint8_t expected[64];                                       // Independent ECB encryption
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        EVP_EncryptInit_ex(ctx, EVP_aes_256_ecb(), nullptr, testKey.data(), nullptr);
+        EVP_CIPHER_CTX_set_padding(ctx, 0);                         // Whole blocks only
+        int outlen;
+        EVP_EncryptUpdate(ctx, expected, &outlen, counters, sizeof(counters));
+        EVP_CIPHER_CTX_free(ctx);
+        return std::memcmp(stream, expected, sizeof(stream)) == 0;
+    }
+
+private:
+    // Load key into the cipher context (key schedule runs here, not per block)
+    void applyKey() {
+        EVP_EncryptInit_ex(ctx, EVP_aes_256_ctr(), nullptr, key.data(), nullptr);
+    }
+
+    // Write the AES-CTR keystream for blocks counter, counter+1, ... into out
+    // (E(key, counter block) per block; only the IV is set, the key schedule is reused)
+    void encryptRun(uint8_t* out, size_t bytes) {
+        uint8_t counterBlock[16] = {};                              // First counter block of the run
+        writeCounter(counterBlock + 8, counter);                    // Counter in the second half
+        EVP_EncryptInit_ex(ctx, nullptr, nullptr, nullptr, counterBlock); // Set IV only
+        std::memset(out, 0, bytes);                                 // Zero plaintext, so out = keystream
+        int outlen;                                                 // Length of output buffer
+        EVP_EncryptUpdate(ctx, out, &outlen, out, static_cast<int>(bytes)); // CTR increments per block
+    }
+
+    // Store a 64-bit counter in big-endian order
+    static void writeCounter(uint8_t* dst, uint64_t value) {
+        uint64_t be = htobe64(value);                               // Convert to big-endian
+        std::memcpy(dst, &be, sizeof(be));                          // Unaligned-safe store
     }
 };
 
@@ -140,30 +683,692 @@ public:
         generator.setKey(initialSeed);                              // Set generator key with loaded seed
     }
 
+    // Constructor: use the slot owned by tag in a shared seed store
+    Fortuna(std::shared_ptr<SeedStore> store, uint64_t tag) : seedManager(std::move(store), tag) {
+        auto initialSeed = seedManager.loadSeed();                  // Load seed from our slot (or generate)
+        generator.setKey(initialSeed);                              // Set generator key with loaded seed
+    }
+
     // Reseed generator using entropy from accumulator
     void reseed() {
         auto newSeed = accumulator.getReseedEntropy();              // Get fresh entropy
-        generator.setKey(newSeed);                                  // Set new key
-        seedManager.saveSeed(newSeed);                              // Save updated seed to disk
+        generator.reseed(newSeed);                                  // Mix into the current key
+        seedManager.saveSeed(getRandomBytes(SeedStore::SEED_SIZE)); // Save generator output as the next seed
     }
 
     // Generate arbitrary number of random bytes
     std::vector<uint8_t> getRandomBytes(size_t numBytes) {
         std::vector<uint8_t> result;                                // Result buffer
-        while (result.size() < numBytes) {                          // Loop until enough bytes generated
-            auto block = generator.generateBlock();                 // Generate next block
-            result.insert(result.end(), block.begin(), block.end()); // Append block to result
-        }
-        result.resize(numBytes);                                    // Trim to requested size
+        fillRandomBytes(result, numBytes);                          // Generate into result
+        return result;                                              // Return result
+    }
+
+    // Generate arbitrary number of random bytes into a buffer allocated from resource
+    // (e.g. a request-scoped std::pmr::monotonic_buffer_resource)
+    std::pmr::vector<uint8_t> getRandomBytes(size_t numBytes, std::pmr::memory_resource* resource) {
+        std::pmr::vector<uint8_t> result(resource);                 // Result buffer backed by resource
+        fillRandomBytes(result, numBytes);                          // Generate into result
         return result;                                              // Return result
     }
 
+    // Generate exactly N random bytes with no loop or heap allocation (fast path for fixed sizes)
+    // Produces the same bytes as getRandomBytes(N) would
+    template <size_t N>
+    std::array<uint8_t, N> get() {
+        static_assert(N > 0, "get<N>() requires N > 0");
+        constexpr size_t blocks = (N + 15) / 16;                    // Keystream blocks needed
+        std::array<uint8_t, blocks * 16> buffer;                    // Whole blocks on the stack
+        generator.generateBlocks<blocks>(buffer.data());            // Fill buffer in one shot
+        std::array<uint8_t, N> result;                              // Returned by value
+        std::memcpy(result.data(), buffer.data(), N);               // Drop the tail of the last block
+        return result;                                              // Return result
+    }
+
+    // Generate whole 16-byte blocks straight into out (caller-owned buffer, no allocation)
+    void getRandomBlocks(uint8_t* out, size_t blocks) {
+        generator.generate(out, blocks);                            // Batched CTR into the buffer
+    }
+
     // Get reference to accumulator (to add entropy externally)
     EntropyAccumulator& getAccumulator() { return accumulator; }
+
+private:
+    // Size result to whole blocks (one allocation), generate into it directly, then trim
+    template <typename Buffer>
+    void fillRandomBytes(Buffer& result, size_t numBytes) {
+        result.resize((numBytes + 15) / 16 * 16);                   // Whole blocks
+        generator.generate(result.data(), result.size() / 16);      // Batched CTR straight into the buffer
+        result.resize(numBytes);                                    // Trim to requested size
+    }
 };
 
+// Class: UniformStream - uniform doubles in (0, 1) cut from bulk keystream
+//
+// Refills are sized from the number of uniforms the caller still expects to
+// need (capped at CHUNK), so a small batch does not burn a whole chunk.
+class UniformStream {
+    static const size_t CHUNK = 1024;                               // Largest refill in bytes
+    Fortuna& fortuna;                                               // Keystream source
+    std::array<uint8_t, CHUNK> buffer;                              // Current keystream chunk
+    size_t pos = 0;                                                 // Next unused byte
+    size_t filled = 0;                                              // Bytes of keystream in buffer
+    size_t expected;                                                // Uniforms the caller still expects to use
+
+public:
+    // expectedDraws: how many uniforms the batch is likely to need
+    UniformStream(Fortuna& source, size_t expectedDraws) : fortuna(source), expected(expectedDraws) {}
+
+    // Next uniform double in (0, 1) with 53 random bits
+    double next() {
+        if (pos == filled) {
+            size_t want = std::max<size_t>(expected, 2) * sizeof(uint64_t); // At least one block
+            size_t blocks = (std::min(want, CHUNK) + 15) / 16;      // Whole blocks, capped at CHUNK
+            fortuna.getRandomBlocks(buffer.data(), blocks);         // Batched CTR straight into the buffer
+            filled = blocks * 16;
+            pos = 0;
+        }
+        if (expected > 0) --expected;
+        uint64_t bits;
+        std::memcpy(&bits, buffer.data() + pos, sizeof(bits));      // Take 8 keystream bytes
+        pos += sizeof(bits);
+        return ((bits >> 11) + 0.5) * (1.0 / 9007199254740992.0);   // Never exactly 0 or 1
+    }
+};
+
+// Class: PoissonSampler - batch Poisson draws for a fixed mean
+//
+// Small means use inversion against a precomputed CDF table; means of 10 and
+// above use Hoermann's PTRS transformed rejection, with its constants
+// computed once per sampler rather than once per draw.
+class PoissonSampler {
+    static constexpr double MAX_MEAN = 2147483648.0;                // Keeps draws well inside uint32_t
+    double mean;                                                    // Poisson mean
+    std::vector<double> cdf;                                        // Inversion table (small means)
+    double a, b, invAlpha, vr, logMean;                             // PTRS constants (large means)
+
+    // Inversion: first k with cdf[k] >= u, extending past the table if needed
+    uint32_t inversion(double u) const {
+        for (size_t k = 0; k < cdf.size(); ++k) {
+            if (u <= cdf[k]) return static_cast<uint32_t>(k);
+        }
+        uint32_t k = static_cast<uint32_t>(cdf.size() - 1);         // Tail beyond the table (very rare)
+        double p = std::exp(-mean + k * logMean - std::lgamma(k + 1.0));
+        double c = cdf.back();
+        while (u > c && p > 0) {
+            ++k;
+            p *= mean / k;                                          // pmf(k) from pmf(k-1)
+            c += p;
+        }
+        return k;
+    }
+
+    // PTRS: one draw by transformed rejection
+    uint32_t ptrs(UniformStream& uniforms) const {
+        for (;;) {
+            double u = uniforms.next() - 0.5;
+            double v = uniforms.next();
+            double us = 0.5 - std::fabs(u);
+            double k = std::floor((2 * a / us + b) * u + mean + 0.43);
+            if (us >= 0.07 && v <= vr) return static_cast<uint32_t>(k); // Fast acceptance
+            if (k < 0 || k > UINT32_MAX || (us < 0.013 && v > us)) continue; // Fast rejection (and range)
+            if (std::log(v * invAlpha / (a / (us * us) + b)) <=
+                -mean + k * logMean - std::lgamma(k + 1)) {
+                return static_cast<uint32_t>(k);
+            }
+        }
+    }
+
+public:
+    explicit PoissonSampler(double lambda) : mean(lambda) {
+        if (!(lambda > 0) || !(lambda <= MAX_MEAN)) {               // Also rejects NaN and infinity
+            throw std::invalid_argument("PoissonSampler: mean must be positive, finite and at most 2^31");
+        }
+        logMean = std::log(mean);
+        if (mean < 10) {
+            double p = std::exp(-mean);                             // pmf(0)
+            double c = p;
+            cdf.push_back(c);
+            for (uint32_t k = 1; c < 1 - 1e-15 && k < 128; ++k) {   // Until the tail is negligible
+                p *= mean / k;
+                c += p;
+                cdf.push_back(c);
+            }
+        } else {
+            double smu = std::sqrt(mean);
+            b = 0.931 + 2.53 * smu;
+            a = -0.059 + 0.02483 * b;
+            invAlpha = 1.1239 + 1.1328 / (b - 3.4);
+            vr = 0.9277 - 3.6224 / (b - 2);
+        }
+    }
+
+    // Fill out with count draws
+    void sample(Fortuna& fortuna, uint32_t* out, size_t count) const {
+        size_t expected = cdf.empty() ? count * 9 / 4 + 2 : count; // PTRS: two uniforms per try, ~90% accepted
+        UniformStream uniforms(fortuna, expected);                  // Shared keystream for the batch
+        if (!cdf.empty()) {
+            for (size_t i = 0; i < count; ++i) out[i] = inversion(uniforms.next());
+        } else {
+            for (size_t i = 0; i < count; ++i) out[i] = ptrs(uniforms);
+        }
+    }
+
+    // Return count draws
+    std::vector<uint32_t> sample(Fortuna& fortuna, size_t count) const {
+        std::vector<uint32_t> out(count);
+        sample(fortuna, out.data(), count);
+        return out;
+    }
+};
+
+// Class: BinomialSampler - batch binomial draws for fixed n and p
+//
+// Works with p <= 0.5 and mirrors the result otherwise. When n*p < 10 it uses
+// inversion against a precomputed CDF table; larger cases use Hoermann's BTRS
+// transformed rejection with per-sampler constants.
+class BinomialSampler {
+    uint32_t n;                                                     // Number of trials
+    double p;                                                       // Success probability (<= 0.5)
+    bool flipped;                                                   // True if the caller's p was > 0.5
+    std::vector<double> cdf;                                        // Inversion table (small n*p)
+    double a, b, c, vr, alpha, logPQ, m, h;                         // BTRS constants (large n*p)
+
+    // Inversion: first k with cdf[k] >= u
+    uint32_t inversion(double u) const {
+        for (size_t k = 0; k < cdf.size(); ++k) {
+            if (u <= cdf[k]) return static_cast<uint32_t>(k);
+        }
+        return static_cast<uint32_t>(cdf.size() - 1);               // Rounding slack at the top
+    }
+
+    // BTRS: one draw by transformed rejection
+    uint32_t btrs(UniformStream& uniforms) const {
+        for (;;) {
+            double u = uniforms.next() - 0.5;
+            double v = uniforms.next();
+            double us = 0.5 - std::fabs(u);
+            double k = std::floor((2 * a / us + b) * u + c);
+            if (k < 0 || k > n) continue;                           // Outside the support
+            if (us >= 0.07 && v <= vr) return static_cast<uint32_t>(k); // Fast acceptance
+            if (std::log(v * alpha / (a / (us * us) + b)) <=
+                h - std::lgamma(k + 1) - std::lgamma(n - k + 1) + (k - m) * logPQ) {
+                return static_cast<uint32_t>(k);
+            }
+        }
+    }
+
+public:
+    BinomialSampler(uint32_t trials, double prob) : n(trials), p(prob), flipped(prob > 0.5) {
+        if (!(prob >= 0 && prob <= 1)) throw std::invalid_argument("BinomialSampler: p must be in [0, 1]");
+        if (flipped) p = 1 - p;                                     // Sample failures instead
+        double q = 1 - p;
+        if (n * p < 10) {
+            double f = std::pow(q, n);                              // pmf(0)
+            double sum = f;
+            cdf.push_back(sum);
+            for (uint32_t k = 0; k < n && sum < 1 - 1e-15; ++k) {   // Until the tail is negligible
+                f *= (double(n - k) / (k + 1)) * (p / q);           // pmf(k+1) from pmf(k)
+                sum += f;
+                cdf.push_back(sum);
+            }
+        } else {
+            double spq = std::sqrt(n * p * q);
+            b = 1.15 + 2.53 * spq;
+            a = -0.0873 + 0.0248 * b + 0.01 * p;
+            c = n * p + 0.5;
+            vr = 0.92 - 4.2 / b;
+            alpha = (2.83 + 5.1 / b) * spq;
+            logPQ = std::log(p / q);
+            m = std::floor((n + 1) * p);
+            h = std::lgamma(m + 1) + std::lgamma(n - m + 1);
+        }
+    }
+
+    // Fill out with count draws
+    void sample(Fortuna& fortuna, uint32_t* out, size_t count) const {
+        size_t expected = cdf.empty() ? count * 9 / 4 + 2 : count; // BTRS: two uniforms per try, ~90% accepted
+        UniformStream uniforms(fortuna, expected);                  // Shared keystream for the batch
+        if (!cdf.empty()) {
+            for (size_t i = 0; i < count; ++i) out[i] = inversion(uniforms.next());
+        } else {
+            for (size_t i = 0; i < count; ++i) out[i] = btrs(uniforms);
+        }
+        if (flipped) {
+            for (size_t i = 0; i < count; ++i) out[i] = n - out[i]; // Undo the p > 0.5 mirror
+        }
+    }
+
+    // Return count draws
+    std::vector<uint32_t> sample(Fortuna& fortuna, size_t count) const {
+        std::vector<uint32_t> out(count);
+        sample(fortuna, out.data(), count);
+        return out;
+    }
+};
+
+// Class: FortunaRegistry - named, independent Fortuna instances sharing one entropy feed
+//
+// Each tenant gets its own generator, pools and a process-owned seed slot, so the
+// same tenant hosted by several processes never shares a seed. Entropy is harvested
+// once and fanned out: the event is hashed once, then every tenant receives
+// SHA-256(tenantKey || eventHash), so tenants never see identical pool input
+// and the per-tenant cost does not depend on the event size.
+//
+// Thread safety: the tenant map is guarded by a shared mutex (shared for lookups
+// and the fan-out, exclusive for lazy creation), and each tenant has its own
+// mutex that addEntropy() holds while feeding it. A collector thread may call
+// addEntropy() while request threads call with(); with() runs its callback under
+// the tenant's mutex. get() returns an unsynchronised reference and is only safe
+// when nothing else uses that tenant at the same time.
+class FortunaRegistry {
+    struct Tenant {
+        std::mutex lock;                                            // Serialises use of this tenant
+        Fortuna fortuna;                                            // Tenant's own PRNG
+        std::array<uint8_t, 32> key;                                // Per-tenant derivation key
+
+        explicit Tenant(std::shared_ptr<SeedStore> store)
+            : fortuna(std::move(store), SeedStore::processTag()) {  // Own slot, released on exit
+            RAND_bytes(key.data(), key.size());                     // Fresh derivation key
+        }
+    };
+
+    std::shared_ptr<SeedStore> store;                               // One seed file, one slot per tenant
+    mutable std::shared_mutex tenantsLock;                          // Guards the tenants map
+    std::map<std::string, std::unique_ptr<Tenant>> tenants;         // Tenants created so far
+
+    // Find the tenant, creating it on first use (returned pointer stays valid)
+    Tenant& tenant(const std::string& name) {
+        {
+            std::shared_lock<std::shared_mutex> read(tenantsLock);  // Common case: already exists
+            auto it = tenants.find(name);
+            if (it != tenants.end()) return *it->second;
+        }
+        std::unique_lock<std::shared_mutex> write(tenantsLock);     // Create under exclusive lock
+        auto& slot = tenants[name];                                 // Re-check: another thread may have won
+        if (!slot) slot.reset(new Tenant(store));
+        return *slot;
+    }
+
+public:
+    // Constructor: open the shared seed store (tenants run without persistence if it
+    // cannot be opened; throws SeedStoreCorrupt if the file is not a valid store)
+    explicit FortunaRegistry(const std::string& seedPath = "seeds.dat")
+        : store(SeedManager::openStore(seedPath)) {}
+
+    FortunaRegistry(const FortunaRegistry&) = delete;
+    FortunaRegistry& operator=(const FortunaRegistry&) = delete;
+
+    // Get the tenant's instance, creating it on first use (unsynchronised; see class comment)
+    Fortuna& get(const std::string& name) {
+        return tenant(name).fortuna;                                // Return tenant's PRNG
+    }
+
+    // Run fn(Fortuna&) on the tenant's instance under its mutex, creating it on first use
+    template <typename Fn>
+    auto with(const std::string& name, Fn fn) -> decltype(fn(std::declval<Fortuna&>())) {
+        Tenant& t = tenant(name);
+        std::lock_guard<std::mutex> guard(t.lock);                  // Exclude the fan-out and other callers
+        return fn(t.fortuna);
+    }
+
+    // Fan one harvested entropy event out to every tenant's accumulator
+    void addEntropy(const std::vector<uint8_t>& data, int source = 0) {
+        uint8_t input[64];                                          // tenantKey || eventHash
+        SHA256(data.data(), data.size(), input + 32);               // Hash the event once
+        std::vector<uint8_t> derived(SHA256_DIGEST_LENGTH);         // Per-tenant pool input
+        std::shared_lock<std::shared_mutex> read(tenantsLock);      // Map stays stable during the fan-out
+        for (auto& entry : tenants) {
+            Tenant& t = *entry.second;
+            std::memcpy(input, t.key.data(), 32);                   // Tenant's key
+            SHA256(input, sizeof(input), derived.data());           // Cheap fixed-size derivation
+            std::lock_guard<std::mutex> guard(t.lock);              // Exclude concurrent with() calls
+            t.fortuna.getAccumulator().addEntropy(derived, source); // Feed tenant's pools
+        }
+    }
+
+    // Number of tenants created so far
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> read(tenantsLock);
+        return tenants.size();
+    }
+};
+
+#ifdef FORTUNA_BENCH
+#include <linux/perf_event.h>        // For hardware performance counters
+#include <sys/ioctl.h>               // For enabling/disabling counters
+#include <sys/syscall.h>             // For the perf_event_open syscall
+#include <random>                    // For standard-library distribution baselines
+
+// Class: PerfCounters - optional hardware counters around each benchmark (Linux perf_event_open)
+//
+// Cycles and instructions form one small group, so they are always scheduled
+// together and IPC compares counts from the same time window. The miss counters
+// are opened on their own: a single six-event group may not fit the PMU at all,
+// in which case the kernel never schedules it. Each standalone counter is
+// scaled by its own enabled/running times.
+class PerfCounters {
+public:
+    static const int COUNT = 6;                                     // Number of counters
+    enum { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, DTLB_MISSES, BRANCH_MISSES };
+    static constexpr double UNAVAILABLE = -1;                       // Counter could not be opened
+    static constexpr double NOT_SCHEDULED = -2;                     // Opened, but never ran on the PMU
+
+private:
+    int fds[COUNT];                                                 // One fd per counter (-1 if unavailable)
+    int group = -1;                                                 // Cycles/instructions group leader fd
+    int position[COUNT];                                            // Index in the group read (-1 if standalone)
+    int members = 0;                                                // Counters in the group
+
+    // Open one user-space-only counter for this thread, joining groupFd (or leading a new one if -1)
+    static int openCounter(uint32_t type, uint64_t config, int groupFd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = groupFd < 0;                                // Leaders start their whole group
+        attr.exclude_kernel = 1;                                    // Works with perf_event_paranoid <= 2
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;          // Same layout for groups and singletons
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+    }
+
+    // Encode a hardware cache event (cache, op, result)
+    static uint64_t cache(uint64_t id, uint64_t op, uint64_t result) {
+        return id | (op << 8) | (result << 16);
+    }
+
+    // Open counter index into the cycles/instructions group
+    void addGrouped(int index, uint32_t type, uint64_t config) {
+        fds[index] = openCounter(type, config, group);
+        position[index] = -1;
+        if (fds[index] < 0) return;                                 // Not supported here
+        if (group < 0) group = fds[index];                          // First counter leads the group
+        position[index] = members++;
+    }
+
+    // Open counter index as its own single-event group
+    void addStandalone(int index, uint32_t type, uint64_t config) {
+        fds[index] = openCounter(type, config, -1);
+        position[index] = -1;
+    }
+
+    // True if fd leads a group (the cycles/instructions leader or a standalone counter)
+    bool leads(int index) const {
+        return fds[index] >= 0 && (position[index] < 0 || fds[index] == group);
+    }
+
+    // Read a group led by fd: store count values (scaled for multiplexing) at out[0..count)
+    static void readGroup(int fd, int count, double* out) {
+        uint64_t data[3 + COUNT];                                   // nr, time enabled, time running, values
+        ssize_t expected = static_cast<ssize_t>((3 + count) * sizeof(uint64_t));
+        if (read(fd, data, sizeof(data)) != expected) return;       // Leave UNAVAILABLE
+        for (int i = 0; i < count; ++i) out[i] = NOT_SCHEDULED;
+        if (data[2] == 0) return;                                   // Time running 0: PMU never took it
+        double scale = static_cast<double>(data[1]) / data[2];
+        for (int i = 0; i < count; ++i) out[i] = data[3 + i] * scale;
+    }
+
+public:
+    // Counter values of one measurement (UNAVAILABLE or NOT_SCHEDULED if no count)
+    struct Sample {
+        double values[COUNT];
+    };
+
+    PerfCounters() {
+        addGrouped(CYCLES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        addGrouped(INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        addStandalone(L1D_MISSES, PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                                             PERF_COUNT_HW_CACHE_RESULT_MISS));
+        addStandalone(LLC_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        addStandalone(DTLB_MISSES, PERF_TYPE_HW_CACHE, cache(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                                                              PERF_COUNT_HW_CACHE_RESULT_MISS));
+        addStandalone(BRANCH_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    }
+
+    ~PerfCounters() {
+        for (int fd : fds) {
+            if (fd >= 0) close(fd);                                 // Release counter
+        }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // True if at least one counter could be opened
+    bool available() const {
+        for (int fd : fds) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    // Reset and start all counters
+    void start() {
+        for (int i = 0; i < COUNT; ++i) {
+            if (!leads(i)) continue;
+            ioctl(fds[i], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(fds[i], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+
+    // Stop all counters and read them, scaling each group for multiplexing
+    Sample stop() {
+        for (int i = 0; i < COUNT; ++i) {
+            if (leads(i)) ioctl(fds[i], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        }
+        Sample sample;
+        for (double& value : sample.values) value = UNAVAILABLE;
+        if (group >= 0) {
+            double grouped[COUNT] = {UNAVAILABLE, UNAVAILABLE, UNAVAILABLE, UNAVAILABLE, UNAVAILABLE, UNAVAILABLE};
+            readGroup(group, members, grouped);                     // Cycles and instructions, one window
+            for (int i = 0; i < COUNT; ++i) {
+                if (position[i] >= 0) sample.values[i] = grouped[position[i]];
+            }
+        }
+        for (int i = 0; i < COUNT; ++i) {
+            if (fds[i] >= 0 && position[i] < 0) readGroup(fds[i], 1, &sample.values[i]);
+        }
+        return sample;
+    }
+};
+
+PerfCounters* perfCounters = nullptr;                               // Set by --perf
+
+// Minimal URBG adapter over Fortuna, the per-draw baseline for the samplers
+struct FortunaEngine {
+    typedef uint32_t result_type;
+    Fortuna& fortuna;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+    result_type operator()() {
+        auto bytes = fortuna.get<4>();                              // One keystream block per draw
+        uint32_t value;
+        std::memcpy(&value, bytes.data(), sizeof(value));
+        return value;
+    }
+};
+
+// Buffered URBG adapter: 32-bit words cut from ~1 KiB keystream refills, isolating the keystream cost
+struct BufferedFortunaEngine {
+    typedef uint32_t result_type;
+    static const size_t BLOCKS = 64;                                // 1 KiB per refill
+    Fortuna& fortuna;
+    std::array<uint8_t, BLOCKS * 16> buffer;
+    size_t pos = BLOCKS * 16;                                       // Empty until first draw
+    explicit BufferedFortunaEngine(Fortuna& source) : fortuna(source) {}
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+    result_type operator()() {
+        if (pos == buffer.size()) {
+            fortuna.getRandomBlocks(buffer.data(), BLOCKS);         // Batched CTR refill
+            pos = 0;
+        }
+        uint32_t value;
+        std::memcpy(&value, buffer.data() + pos, sizeof(value));    // Use all 16 bytes of each block
+        pos += sizeof(value);
+        return value;
+    }
+};
+
+// Print one counter as per-call and per-byte figures
+void printCounter(const char* label, double value, size_t calls, size_t bytes) {
+    if (value < 0) {
+        printf("    %-14s %12s\n", label, value == PerfCounters::NOT_SCHEDULED ? "not scheduled" : "n/a");
+        return;
+    }
+    printf("    %-14s %12.2f /call %10.3f /byte\n", label, value / calls, value / bytes);
+}
+
+// Benchmark helper: run fn `iterations` times, print ns/call and MB/s (plus counters with --perf), return ns/call
+template <typename Fn>
+double benchmark(const char* name, size_t bytesPerCall, size_t iterations, Fn fn) {
+    uint8_t sink = 0;                                               // Keeps results observable
+    if (perfCounters) perfCounters->start();                        // Start hardware counters
+    auto start = std::chrono::steady_clock::now();                  // Start timer
+    for (size_t i = 0; i < iterations; ++i) {
+        sink += fn();                                               // Run one call
+    }
+    auto end = std::chrono::steady_clock::now();                    // Stop timer
+    PerfCounters::Sample sample = {};
+    if (perfCounters) sample = perfCounters->stop();                // Stop hardware counters
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    printf("%-34s %10.1f ns/call %10.2f MB/s  (sink %02x)\n", name,
+           ns / iterations, (bytesPerCall * iterations) / (ns / 1e9) / 1e6, sink);
+    if (!perfCounters) return ns / iterations;
+
+    size_t bytes = bytesPerCall * iterations;                       // Total bytes processed
+    const double* v = sample.values;
+    printCounter("cycles", v[PerfCounters::CYCLES], iterations, bytes);
+    printCounter("instructions", v[PerfCounters::INSTRUCTIONS], iterations, bytes);
+    if (v[PerfCounters::CYCLES] > 0 && v[PerfCounters::INSTRUCTIONS] >= 0) {
+        printf("    %-14s %12.2f\n", "IPC", v[PerfCounters::INSTRUCTIONS] / v[PerfCounters::CYCLES]);
+    }
+    printCounter("L1D misses", v[PerfCounters::L1D_MISSES], iterations, bytes);
+    printCounter("LLC misses", v[PerfCounters::LLC_MISSES], iterations, bytes);
+    printCounter("dTLB misses", v[PerfCounters::DTLB_MISSES], iterations, bytes);
+    printCounter("branch misses", v[PerfCounters::BRANCH_MISSES], iterations, bytes);
+    return ns / iterations;
+}
+
+// Entry point: benchmark generator, accumulator and Fortuna paths (pass --perf for hardware counters)
+int main(int argc, char** argv) {
+    std::unique_ptr<PerfCounters> counters;                         // Opened once with --perf, reused per benchmark
+    if (argc > 1 && std::strcmp(argv[1], "--perf") == 0) {
+        counters.reset(new PerfCounters());
+        if (counters->available()) {
+            perfCounters = counters.get();                          // Enable counter reporting
+        } else {
+            printf("perf_event_open unavailable, reporting timings only\n");
+        }
+    }
+
+    Fortuna fortuna;                                                // Create Fortuna PRNG instance
+    const size_t iterations = 200000;                               // Calls per benchmark
+
+    Generator generator;                                            // Standalone generator kernel
+    benchmark("Generator::generateBlock", 16, iterations, [&] { return generator.generateBlock()[0]; });
+    std::array<uint8_t, 64> blocks;                                 // Output for the batched kernel
+    benchmark("Generator::generateBlocks<4>", 64, iterations, [&] {
+        generator.generateBlocks<4>(blocks.data());
+        return blocks[0];
+    });
+
+    EntropyAccumulator accumulator;                                 // Standalone accumulator
+    std::vector<uint8_t> event(64, 0x5a);                           // Typical entropy event
+    int source = 0;
+    benchmark("EntropyAccumulator::add", 64, iterations, [&] {
+        accumulator.addEntropy(event, source++);                    // Spread over all pools
+        return event[0];
+    });
+    benchmark("EntropyAccumulator::reseed", 64, iterations / 10, [&] {
+        accumulator.addEntropy(event, source++);                    // One event per reseed
+        return accumulator.getReseedEntropy()[0];
+    });
+
+    EntropyAccumulator rawAccumulator;                              // Pools behind the conditioner
+    EntropyConditioner conditioner(rawAccumulator, 8);              // 8:1 Toeplitz extraction
+    std::vector<uint8_t> frame(4096);                               // Simulated raw sensor frame
+    RAND_bytes(frame.data(), frame.size());
+    benchmark("EntropyConditioner::addRaw", frame.size(), iterations / 100, [&] {
+        conditioner.addRaw(frame, 1);
+        return rawAccumulator.getReseedEntropy()[0];                // Keep pool memory bounded
+    });
+    benchmark("EntropyAccumulator (raw)", frame.size(), iterations / 100, [&] {
+        rawAccumulator.addEntropy(frame, 1);                        // Same frames without conditioning
+        return rawAccumulator.getReseedEntropy()[0];
+    });
+    EntropyConditioner::Stats stats = conditioner.stats(1);
+    printf("    conditioner source 1: %.1f:1 compression, %.2f MB/s through the stage\n",
+           stats.compressionRatio(), stats.throughputMBs());
+
+    benchmark("getRandomBytes(16)", 16, iterations, [&] { return fortuna.getRandomBytes(16)[0]; });
+    benchmark("get<16>()", 16, iterations, [&] { return fortuna.get<16>()[0]; });
+    benchmark("getRandomBytes(32)", 32, iterations, [&] { return fortuna.getRandomBytes(32)[0]; });
+    benchmark("get<32>()", 32, iterations, [&] { return fortuna.get<32>()[0]; });
+    benchmark("getRandomBytes(64)", 64, iterations, [&] { return fortuna.getRandomBytes(64)[0]; });
+    benchmark("get<64>()", 64, iterations, [&] { return fortuna.get<64>()[0]; });
+
+    const size_t batch = 4096;                                      // Draws per sampler call
+    std::vector<uint32_t> draws(batch);
+    FortunaEngine engine{fortuna};
+    BufferedFortunaEngine buffered(fortuna);
+    struct SamplerCase { const char* name; double mean; uint32_t n; double p; };
+    const SamplerCase cases[] = {
+        {"poisson(3)", 3, 0, 0}, {"poisson(500)", 500, 0, 0},
+        {"binomial(20,0.3)", 0, 20, 0.3}, {"binomial(10000,0.4)", 0, 10000, 0.4},
+    };
+    for (const SamplerCase& sc : cases) {
+        char label[64];
+        // Time one sampler / std distribution pair against both engines
+        auto compare = [&](auto& sampler, auto& dist) {
+            snprintf(label, sizeof(label), "%s batch", sc.name);
+            double batchNs = benchmark(label, batch * 4, 50, [&] {
+                sampler.sample(fortuna, draws.data(), batch);
+                return uint8_t(draws[0]);
+            });
+            snprintf(label, sizeof(label), "%s std", sc.name);
+            double stdNs = benchmark(label, batch * 4, 50, [&] {
+                for (size_t i = 0; i < batch; ++i) draws[i] = dist(engine);
+                return uint8_t(draws[0]);
+            });
+            snprintf(label, sizeof(label), "%s std buffered", sc.name);
+            double bufferedNs = benchmark(label, batch * 4, 50, [&] {
+                for (size_t i = 0; i < batch; ++i) draws[i] = dist(buffered);
+                return uint8_t(draws[0]);
+            });
+            printf("    gain: %.2fx keystream (std / std buffered), %.2fx algorithm (std buffered / batch)\n",
+                   stdNs / bufferedNs, bufferedNs / batchNs);
+        };
+        if (sc.mean > 0) {
+            PoissonSampler sampler(sc.mean);
+            std::poisson_distribution<uint32_t> dist(sc.mean);
+            compare(sampler, dist);
+        } else {
+            BinomialSampler sampler(sc.n, sc.p);
+            std::binomial_distribution<uint32_t> dist(sc.n, sc.p);
+            compare(sampler, dist);
+        }
+    }
+
+    std::array<uint8_t, 4096> arena;                                // Stack arena for the pmr benchmark
+    benchmark("getRandomBytes(64, pmr)", 64, iterations, [&] {
+        std::pmr::monotonic_buffer_resource resource(arena.data(), arena.size()); // Request-scoped arena
+        return fortuna.getRandomBytes(64, &resource)[0];            // Freed in one shot with the arena
+    });
+
+    return 0;                                                       // Exit successfully
+}
+#else
 // Entry point: simple test to demonstrate Fortuna
 int main() {
+    // Check the keystream against AES-256-ECB before using it
+    if (!Generator::knownAnswerTest()) {
+        std::cerr << "Generator known-answer test failed" << std::endl;
+        return 1;
+    }
+
     Fortuna fortuna;                                                // Create Fortuna PRNG instance
 
     // Add some manual entropy (simulating sensor input or user activity)
@@ -185,3 +1390,4 @@ int main() {
 
     return 0;                                                       // Exit successfully
 }
+#endif